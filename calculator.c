@@ -13,6 +13,26 @@
 #include <readline/readline.h>
 #include <readline/history.h>
 
+/*
+ * Static tracepoints. USDT probes are built in whenever sys/sdt.h is
+ * available so that tools like bpftrace can attach to a running process.
+ * A disabled probe is a single nop. Build with -DNO_SDT to leave them out.
+ */
+#if !defined(NO_SDT) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#define HAVE_SDT
+#endif
+#endif
+
+#ifdef HAVE_SDT
+#include <sys/sdt.h>
+#define TRACE1(name, a)     DTRACE_PROBE1(calc, name, a)
+#define TRACE2(name, a, b)  DTRACE_PROBE2(calc, name, a, b)
+#else
+#define TRACE1(name, a)
+#define TRACE2(name, a, b)
+#endif
+
 /*
  * Global configuration flags.
  */
@@ -240,7 +260,7 @@ const char* tokToStr(TokType tok) {
 void create_buf() {
 
     buffer = malloc(sizeof(InputBuffer));
-    buffer->cap = 1 << 3;
+    buffer->cap = 1 << 10;  // large enough that typical lines never realloc
     buffer->idx = 0;
     buffer->len = 0;
     buffer->buf = malloc(buffer->cap);
@@ -504,6 +524,7 @@ void consume_token() {
     if(tok.str != NULL)
         free((void*)tok.str);
     tok.str = strdup(buf);
+    TRACE2(token, tok.type, tok.str);
 }
 
 /*
@@ -716,15 +737,22 @@ int main() {
         }
 
         if(!finished) {
+            TRACE1(line__start, line);
             reset_buf();
             load_buf(line);
 
             if(expr != NULL)
                 free_expr(expr);
 
+            TRACE1(convert__start, line);
             expr = convert();
-            if(solve_flag)
+            TRACE1(convert__end, expr);
+            if(solve_flag) {
+                TRACE1(solve__start, expr);
                 solve(expr);
+                TRACE1(solve__end, expr);
+            }
+            TRACE1(line__end, line);
         }
     }
 